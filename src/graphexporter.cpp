@@ -0,0 +1,193 @@
+#include "graphexporter.h"
+
+// Pending output is written in chunks of this size
+static const std::size_t buffer_size = 1 << 20;
+
+GraphExporter::GraphExporter(Format format, const std::string& file_path):
+  _format(format),
+  _output(stdout),
+  _owns_output(false),
+  _buffer(buffer_size),
+  _buffer_end(0){
+  if(!file_path.empty()){
+    _output = std::fopen(file_path.c_str(), "wb");
+    if(_output == nullptr){
+      throw ArgsErrorException("Unable to write file: " + file_path);
+    }
+    _owns_output = true;
+  }
+}
+
+GraphExporter::~GraphExporter(){
+  if(_thread.joinable()){
+    _thread.join();
+  }
+  if(_owns_output){
+    std::fclose(_output);
+  }
+}
+
+void GraphExporter::take_snapshot(const UndirectedGraph& graph){
+  // Copying vertices and edges so that the graph may change while
+  // writing
+  _vertices.clear();
+  _edges.clear();
+  _vertices.reserve(graph.number_of_vertices());
+  _edges.reserve(graph.number_of_edges());
+
+  graph.visit_by_id([this](unsigned id, unsigned degree){
+                      _vertices.emplace_back(id, degree);
+                    },
+                    [this](const UndirectedGraph::Edge& edge){
+                      _edges.push_back(edge);
+                    });
+};
+
+void GraphExporter::write_snapshot(){
+  switch(_format){
+  case Format::LOG:
+    // Same content as the former UndirectedGraph::log
+    this->append("****************** Graph log ******************\n"
+                 "* Vertices:\n");
+    for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
+      this->append("** Id: ");
+      this->append_number(vertex->first);
+      this->append("\n*** Degree: ");
+      this->append_number(vertex->second);
+      this->append("\n");
+    }
+    this->append("* Edges:\n");
+    for(auto edge = _edges.cbegin(); edge != _edges.cend(); ++edge){
+      this->append_number(edge->_first_vertex);
+      this->append("<--");
+      this->append_number(edge->_weight);
+      this->append("-->");
+      this->append_number(edge->_second_vertex);
+      this->append(" ; ");
+    }
+    this->append("\n");
+    break;
+  case Format::EDGE_LIST:
+    // One "first second weight" line per edge, isolated vertices
+    // having their own line
+    for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
+      if(vertex->second == 0){
+        this->append_number(vertex->first);
+        this->append("\n");
+      }
+    }
+    for(auto edge = _edges.cbegin(); edge != _edges.cend(); ++edge){
+      this->append_number(edge->_first_vertex);
+      this->append(" ");
+      this->append_number(edge->_second_vertex);
+      this->append(" ");
+      this->append_number(edge->_weight);
+      this->append("\n");
+    }
+    break;
+  case Format::DOT:
+    this->append("graph G {\n");
+    for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
+      if(vertex->second == 0){
+        this->append("  ");
+        this->append_number(vertex->first);
+        this->append(";\n");
+      }
+    }
+    for(auto edge = _edges.cbegin(); edge != _edges.cend(); ++edge){
+      this->append("  ");
+      this->append_number(edge->_first_vertex);
+      this->append(" -- ");
+      this->append_number(edge->_second_vertex);
+      this->append(" [weight=");
+      this->append_number(edge->_weight);
+      this->append("];\n");
+    }
+    this->append("}\n");
+    break;
+  case Format::BINARY:
+    // "FTBG" tag, number of vertices and edges, vertices ids then
+    // edges as (first, second, weight), all values being stored as 32
+    // bits unsigned
+    this->append("FTBG", 4);
+    this->append_binary(_vertices.size());
+    this->append_binary(_edges.size());
+    for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
+      this->append_binary(vertex->first);
+    }
+    for(auto edge = _edges.cbegin(); edge != _edges.cend(); ++edge){
+      this->append_binary(edge->_first_vertex);
+      this->append_binary(edge->_second_vertex);
+      this->append_binary(edge->_weight);
+    }
+    break;
+  }
+  this->flush();
+  if(std::fflush(_output) != 0){
+    _error = "Unable to write graph";
+  }
+};
+
+void GraphExporter::append(const char* data, std::size_t size){
+  if(_buffer_end + size > _buffer.size()){
+    this->flush();
+    if(size > _buffer.size()){
+      _buffer.resize(size);
+    }
+  }
+  std::memcpy(_buffer.data() + _buffer_end, data, size);
+  _buffer_end += size;
+};
+
+void GraphExporter::append_number(unsigned number){
+  // Decimal digits, written from the end
+  char digits[16];
+  char* first_digit = digits + sizeof(digits);
+  do{
+    *--first_digit = '0' + (number % 10);
+    number /= 10;
+  } while(number != 0);
+  this->append(first_digit, digits + sizeof(digits) - first_digit);
+};
+
+void GraphExporter::append_binary(uint32_t number){
+  this->append(reinterpret_cast<const char*>(&number), sizeof(uint32_t));
+};
+
+void GraphExporter::flush(){
+  if((_buffer_end > 0)
+     and (std::fwrite(_buffer.data(), 1, _buffer_end, _output)
+          != _buffer_end)){
+    _error = "Unable to write graph";
+  }
+  _buffer_end = 0;
+};
+
+void GraphExporter::write(const UndirectedGraph& graph){
+  this->wait();
+  this->take_snapshot(graph);
+  this->write_snapshot();
+  this->wait();
+};
+
+void GraphExporter::start(const UndirectedGraph& graph){
+  // Only the snapshot is taken on the calling thread, the graph may
+  // be used (and modified) as soon as this returns
+  if(!_owns_output){
+    throw ArgsErrorException("Background writing requires an output file");
+  }
+  this->wait();
+  this->take_snapshot(graph);
+  _thread = std::thread(&GraphExporter::write_snapshot, this);
+};
+
+void GraphExporter::wait(){
+  if(_thread.joinable()){
+    _thread.join();
+  }
+  if(!_error.empty()){
+    std::string error;
+    error.swap(_error);
+    throw ArgsErrorException(error);
+  }
+};
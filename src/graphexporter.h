@@ -0,0 +1,72 @@
+#ifndef GRAPHEXPORTER_H
+#define GRAPHEXPORTER_H
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include "undirectedgraph.h"
+#include "exceptions.h"
+
+class GraphExporter{
+public:
+  // Available output formats
+  enum class Format {LOG, EDGE_LIST, DOT, BINARY};
+
+private:
+  Format _format;
+
+  std::FILE* _output;                   // stdout or opened file
+
+  bool _owns_output;                    // output has to be closed
+
+  std::vector<char> _buffer;            // pending output
+
+  std::size_t _buffer_end;              // pending output size
+
+  std::vector<std::pair<unsigned, unsigned>> _vertices;
+                                        // graph vertices ids along
+                                        // with their degree, by id
+
+  std::vector<UndirectedGraph::Edge> _edges; // graph edges, sorted
+
+  std::thread _thread;                  // background writing
+
+  std::string _error;                   // set if writing failed
+
+  void take_snapshot(const UndirectedGraph& graph);
+
+  void write_snapshot();
+
+  void append(const char* data, std::size_t size);
+
+  // Literal strings, without their final '\0'
+  template<std::size_t size>
+  void append(const char (&text)[size]){
+    this->append(text, size - 1);
+  };
+
+  void append_number(unsigned number);
+
+  void append_binary(uint32_t number);
+
+  void flush();
+
+public:
+
+  GraphExporter(Format format, const std::string& file_path = "");
+
+  ~GraphExporter();
+
+  void write(const UndirectedGraph& graph);
+
+  // Background writing, only allowed when writing to a file as
+  // standard output would interleave with other output
+  void start(const UndirectedGraph& graph);
+
+  void wait();
+};
+
+#endif
@@ -1,10 +1,12 @@
 #include <iostream>
 #include <set>
 #include <list>
+#include <map>
 #include <chrono>
 #include <random>
 #include <unistd.h>
 #include "undirectedgraph.h"
+#include "graphexporter.h"
 #include "exceptions.h"
 
 void display_usage()
@@ -12,6 +14,14 @@ void display_usage()
   std::string usage = "Usage : mwis [-s size]\n";
   usage += "Option:\n";
   usage += "  -s=size\t\t size of the subgraphs\n"; 
+  usage += "  -o=ordering\t\t vertex reordering before search (bfs, rcm, degree)\n"; 
+  usage += "  -l=landmarks\t\t number of landmarks for shortest path\n"; 
+  usage += "  -L=file\t\t save landmarks to file, reload them after reordering\n"; 
+  usage += "  -d=delta\t\t check delta-stepping against Dijkstra (0 for default delta)\n"; 
+  usage += "  -v\t\t\t check input before bridge search\n"; 
+  usage += "  -q\t\t\t quiet mode, graph is not written to standard output\n"; 
+  usage += "  -f=format\t\t graph output format (log, edges, dot, binary with -w)\n"; 
+  usage += "  -w=file\t\t write graph to file, in background\n"; 
   std::cout << usage
             << std::endl;
   exit(0);
@@ -25,12 +35,37 @@ int main(int argc, char **argv){
     bool example;
     // -r option
     unsigned random_subgraphs_size;
+    // -o option
+    bool reorder;
+    UndirectedGraph::VertexOrdering ordering;
+    // -l option
+    unsigned landmarks;
+    // -L option
+    std::string landmarks_path;
+    // -d option
+    bool delta_stepping;
+    unsigned delta;
+    // -v option
+    bool validate;
+    // -q option
+    bool quiet;
+    // -f option
+    GraphExporter::Format format;
+    // -w option
+    std::string output_path;
   } globalArgs;
 
   globalArgs.example = false;
   globalArgs.random_subgraphs_size = 0;
+  globalArgs.reorder = false;
+  globalArgs.landmarks = 0;
+  globalArgs.delta_stepping = false;
+  globalArgs.delta = 0;
+  globalArgs.validate = false;
+  globalArgs.quiet = false;
+  globalArgs.format = GraphExporter::Format::LOG;
 
-  const char* optString = "er:h?";
+  const char* optString = "er:o:l:L:d:vqf:w:h?";
   
   int opt = getopt(argc, argv, optString);
 
@@ -42,6 +77,58 @@ int main(int argc, char **argv){
     case 'r':
       globalArgs.random_subgraphs_size = std::strtol(optarg, nullptr, 10);
       break;
+    case 'o':
+      globalArgs.reorder = true;
+      if(std::string(optarg) == "bfs"){
+        globalArgs.ordering = UndirectedGraph::VertexOrdering::BFS;
+      }
+      else if(std::string(optarg) == "rcm"){
+        globalArgs.ordering
+          = UndirectedGraph::VertexOrdering::REVERSE_CUTHILL_MCKEE;
+      }
+      else if(std::string(optarg) == "degree"){
+        globalArgs.ordering = UndirectedGraph::VertexOrdering::DEGREE;
+      }
+      else{
+        display_usage();
+      }
+      break;
+    case 'l':
+      globalArgs.landmarks = std::strtol(optarg, nullptr, 10);
+      break;
+    case 'L':
+      globalArgs.landmarks_path = optarg;
+      break;
+    case 'd':
+      globalArgs.delta_stepping = true;
+      globalArgs.delta = std::strtol(optarg, nullptr, 10);
+      break;
+    case 'v':
+      globalArgs.validate = true;
+      break;
+    case 'q':
+      globalArgs.quiet = true;
+      break;
+    case 'f':
+      if(std::string(optarg) == "log"){
+        globalArgs.format = GraphExporter::Format::LOG;
+      }
+      else if(std::string(optarg) == "edges"){
+        globalArgs.format = GraphExporter::Format::EDGE_LIST;
+      }
+      else if(std::string(optarg) == "dot"){
+        globalArgs.format = GraphExporter::Format::DOT;
+      }
+      else if(std::string(optarg) == "binary"){
+        globalArgs.format = GraphExporter::Format::BINARY;
+      }
+      else{
+        display_usage();
+      }
+      break;
+    case 'w':
+      globalArgs.output_path = optarg;
+      break;
     case 'h': 
     case '?':
       display_usage();
@@ -52,6 +139,13 @@ int main(int argc, char **argv){
     opt = getopt(argc, argv, optString);
   }
 
+  // Binary output would be mixed with search results on standard
+  // output
+  if((globalArgs.format == GraphExporter::Format::BINARY)
+     and globalArgs.output_path.empty()){
+    display_usage();
+  }
+
   if(globalArgs.example){
     // Basic example
 
@@ -96,22 +190,105 @@ int main(int argc, char **argv){
     // The brigde
     g.add_edge(3, 9, 10);
   
-    g.log();
+    // Writing graph, in background when using a file so that
+    // searches go on meanwhile (-q only applies to standard output)
+    GraphExporter exporter (globalArgs.format, globalArgs.output_path);
+    if(!globalArgs.output_path.empty()){
+      exporter.start(g);
+    }
+    else if(!globalArgs.quiet){
+      exporter.write(g);
+    }
+
+    if(globalArgs.reorder){
+      g.reorder_vertices(globalArgs.ordering);
+    }
 
     // Log bridge search
     unsigned first = 1;
     unsigned second = 12;
 
-    std::pair<unsigned, unsigned> bridge = g.find_the_bridge(first, second);
+    bool valid_input = true;
+    if(globalArgs.validate){
+      UndirectedGraph::ValidationReport report = g.validate(first, second);
+      valid_input = report.is_valid();
+      std::cout << "*******************\n"
+                << "Input check: "
+                << report.describe()
+                << std::endl;
+    }
 
-    std::cout << "*******************\n"
-              << "Using vertices "
-              << first << " and " << second
-              << ", found bridge: "
-              << std::get<0>(bridge)
-              << " <-> "
-              << std::get<1>(bridge)
-              << std::endl;
+    if(valid_input){
+      std::pair<unsigned, unsigned> bridge = g.find_the_bridge(first, second);
+
+      std::cout << "*******************\n"
+                << "Using vertices "
+                << first << " and " << second
+                << ", found bridge: "
+                << std::get<0>(bridge)
+                << " <-> "
+                << std::get<1>(bridge)
+                << std::endl;
+    }
+
+    if(globalArgs.landmarks > 0){
+      // Log shortest path search, using landmarks, checking its weight
+      // against plain Dijkstra
+      unsigned weight = g.path_weight(g.shortest_path(first, second));
+      g.compute_landmarks(globalArgs.landmarks);
+      unsigned landmarks_weight
+        = g.path_weight(g.shortest_path(first, second));
+
+      std::cout << "*******************\n"
+                << "Shortest path weight between vertices "
+                << first << " and " << second
+                << ": "
+                << landmarks_weight
+                << (landmarks_weight == weight ? ", matches" : ", DOES NOT match")
+                << " Dijkstra"
+                << std::endl;
+
+      if(!globalArgs.landmarks_path.empty()){
+        // Saved landmarks have to be usable once ranks changed
+        g.save_landmarks(globalArgs.landmarks_path);
+        g.reorder_vertices(UndirectedGraph::VertexOrdering::DEGREE);
+        g.load_landmarks(globalArgs.landmarks_path);
+        landmarks_weight = g.path_weight(g.shortest_path(first, second));
+
+        std::cout << "*******************\n"
+                  << "Shortest path weight using landmarks from "
+                  << globalArgs.landmarks_path
+                  << ": "
+                  << landmarks_weight
+                  << (landmarks_weight == weight ? ", matches" : ", DOES NOT match")
+                  << " Dijkstra"
+                  << std::endl;
+      }
+    }
+
+    if(globalArgs.delta_stepping){
+      // Checking delta-stepping distances against Dijkstra ones
+      g.use_shortest_path_engine(UndirectedGraph::ShortestPathEngine::DIJKSTRA);
+      std::map<unsigned, unsigned> distances = g.shortest_distances(first);
+      std::list<unsigned> path = g.shortest_path(first, second);
+
+      g.use_shortest_path_engine(UndirectedGraph::ShortestPathEngine::DELTA_STEPPING,
+                                 globalArgs.delta);
+      bool same_distances = (g.shortest_distances(first) == distances);
+      bool same_weight = (g.path_weight(g.shortest_path(first, second))
+                          == g.path_weight(path));
+
+      std::cout << "*******************\n"
+                << "Delta-stepping distances from vertex "
+                << first
+                << (same_distances ? " match" : " DO NOT match")
+                << " Dijkstra, shortest path weight to vertex "
+                << second
+                << (same_weight ? " matches" : " DOES NOT match")
+                << std::endl;
+    }
+
+    exporter.wait();
   }
 
   if(globalArgs.random_subgraphs_size >= 4){
@@ -182,7 +359,15 @@ int main(int argc, char **argv){
       }
     }
     
-    g2.log();
+    // Writing graph, in background when using a file so that
+    // searches go on meanwhile (-q only applies to standard output)
+    GraphExporter exporter (globalArgs.format, globalArgs.output_path);
+    if(!globalArgs.output_path.empty()){
+      exporter.start(g2);
+    }
+    else if(!globalArgs.quiet){
+      exporter.write(g2);
+    }
 
     // Using random vertices to define the bridge (unique edge between
     // the two subgraphs)
@@ -198,6 +383,10 @@ int main(int argc, char **argv){
               << " <-> "
               << bridge_second
               << std::endl;
+
+    if(globalArgs.reorder){
+      g2.reorder_vertices(globalArgs.ordering);
+    }
     
     // Log bridge search
 
@@ -205,17 +394,87 @@ int main(int argc, char **argv){
     unsigned first = first_subgraph_dist(generator);
     unsigned second = second_subgraph_dist(generator);
 
-    std::pair<unsigned, unsigned> bridge = g2.find_the_bridge(first, second);
+    bool valid_input = true;
+    if(globalArgs.validate){
+      UndirectedGraph::ValidationReport report = g2.validate(first, second);
+      valid_input = report.is_valid();
+      std::cout << "*******************\n"
+                << "Input check: "
+                << report.describe()
+                << std::endl;
+    }
+
+    if(valid_input){
+      std::pair<unsigned, unsigned> bridge = g2.find_the_bridge(first, second);
 
-    std::cout << "*******************\n"
-              << "Using vertices "
-              << first << " and " << second
-              << ", found bridge: "
-              << std::get<0>(bridge)
-              << " <-> "
-              << std::get<1>(bridge)
-              << std::endl;
+      std::cout << "*******************\n"
+                << "Using vertices "
+                << first << " and " << second
+                << ", found bridge: "
+                << std::get<0>(bridge)
+                << " <-> "
+                << std::get<1>(bridge)
+                << std::endl;
+    }
+
+    if(globalArgs.landmarks > 0){
+      // Log shortest path search, using landmarks, checking its weight
+      // against plain Dijkstra
+      unsigned weight = g2.path_weight(g2.shortest_path(first, second));
+      g2.compute_landmarks(globalArgs.landmarks);
+      unsigned landmarks_weight
+        = g2.path_weight(g2.shortest_path(first, second));
+
+      std::cout << "*******************\n"
+                << "Shortest path weight between vertices "
+                << first << " and " << second
+                << ": "
+                << landmarks_weight
+                << (landmarks_weight == weight ? ", matches" : ", DOES NOT match")
+                << " Dijkstra"
+                << std::endl;
+
+      if(!globalArgs.landmarks_path.empty()){
+        // Saved landmarks have to be usable once ranks changed
+        g2.save_landmarks(globalArgs.landmarks_path);
+        g2.reorder_vertices(UndirectedGraph::VertexOrdering::DEGREE);
+        g2.load_landmarks(globalArgs.landmarks_path);
+        landmarks_weight = g2.path_weight(g2.shortest_path(first, second));
+
+        std::cout << "*******************\n"
+                  << "Shortest path weight using landmarks from "
+                  << globalArgs.landmarks_path
+                  << ": "
+                  << landmarks_weight
+                  << (landmarks_weight == weight ? ", matches" : ", DOES NOT match")
+                  << " Dijkstra"
+                  << std::endl;
+      }
+    }
+
+    if(globalArgs.delta_stepping){
+      // Checking delta-stepping distances against Dijkstra ones
+      g2.use_shortest_path_engine(UndirectedGraph::ShortestPathEngine::DIJKSTRA);
+      std::map<unsigned, unsigned> distances = g2.shortest_distances(first);
+      std::list<unsigned> path = g2.shortest_path(first, second);
+
+      g2.use_shortest_path_engine(UndirectedGraph::ShortestPathEngine::DELTA_STEPPING,
+                                 globalArgs.delta);
+      bool same_distances = (g2.shortest_distances(first) == distances);
+      bool same_weight = (g2.path_weight(g2.shortest_path(first, second))
+                          == g2.path_weight(path));
+
+      std::cout << "*******************\n"
+                << "Delta-stepping distances from vertex "
+                << first
+                << (same_distances ? " match" : " DO NOT match")
+                << " Dijkstra, shortest path weight to vertex "
+                << second
+                << (same_weight ? " matches" : " DOES NOT match")
+                << std::endl;
+    }
 
+    exporter.wait();
   }
 
 }
@@ -1,54 +1,109 @@
 #include "undirectedgraph.h"
+#include "graphexporter.h"
 
-UndirectedGraph::UndirectedGraph(){}
+UndirectedGraph::UndirectedGraph():
+  _number_of_edges(0),
+  _number_of_removed_vertices(0),
+  _max_weight(0),
+  _engine(ShortestPathEngine::DIJKSTRA),
+  _delta(0),
+  _number_of_threads(0){}
 
 unsigned UndirectedGraph::number_of_vertices() const{
-  return _vertices.size();
+  return _ranks.size();
 };
 
 unsigned UndirectedGraph::number_of_edges() const{
-  return _edges.size();
+  return _number_of_edges;
+};
+
+std::size_t UndirectedGraph::neighbour_position(unsigned rank,
+                                                unsigned neighbour_rank) const{
+  // Position of neighbour_rank in the adjacency of rank, or adjacency
+  // size if they are not adjacent
+  const std::vector<Neighbour>& neighbours = _vertices[rank]._neighbours;
+  std::size_t position = 0;
+  while((position < neighbours.size())
+        and (neighbours[position]._rank != neighbour_rank)){
+    ++position;
+  }
+  return position;
+};
+
+void UndirectedGraph::drop_neighbour(unsigned rank, std::size_t position){
+  // Swap-remove of a single adjacency entry, the reverse entry is left
+  // untouched
+  Vertex& vertex = _vertices[rank];
+  std::size_t last_position = vertex._neighbours.size() - 1;
+  if(position != last_position){
+    Neighbour& moved = vertex._neighbours[position];
+    moved = vertex._neighbours[last_position];
+    // Reverse entry of moved neighbour has to follow
+    _vertices[moved._rank]._neighbours[moved._twin]._twin = position;
+  }
+  vertex._neighbours.pop_back();
+  vertex._degree--;
 };
 
 void UndirectedGraph::add_vertex(unsigned id){
   // Nothing done if some vertex already have this id
-  _vertices.emplace(id, Vertex{});
+  if(_ranks.emplace(id, _vertices.size()).second){
+    _vertices.emplace_back(id);
+    // An isolated vertex can't be reached from any landmark
+    for(auto distances = _landmark_distances.begin();
+        distances != _landmark_distances.end();
+        ++distances){
+      distances->push_back(std::numeric_limits<unsigned>::max());
+    }
+  }
 };
 
 void UndirectedGraph::remove_vertex(unsigned id){
-  auto target_vertex = _vertices.find(id);
-  if(target_vertex != _vertices.end()){
-    // Removing all edges to neighbours of given vertex
-    std::list<unsigned> neighbours = this->neighbours_for_vertex(id);
-    for(auto vertex = neighbours.begin();
-        vertex != neighbours.end();
-        vertex++){
-      Edge target_edge (id, *vertex, 0);
-      _edges.erase(target_edge);
-      // Updating neighbour degree
-      _vertices.find(*vertex)->second._degree--;
-    }
+  auto target_rank = _ranks.find(id);
+  if(target_rank != _ranks.end()){
+    Vertex& vertex = _vertices[target_rank->second];
     
-    // Removing vertex
-    _vertices.erase(target_vertex);
+    // Removing all edges to neighbours of given vertex, each reverse
+    // entry position being known
+    for(auto neighbour = vertex._neighbours.cbegin();
+        neighbour != vertex._neighbours.cend();
+        neighbour++){
+      this->drop_neighbour(neighbour->_rank, neighbour->_twin);
+    }
+    _number_of_edges -= vertex._neighbours.size();
+
+    // Leaving a tombstone in place of the vertex
+    vertex._neighbours.clear();
+    vertex._neighbours.shrink_to_fit();
+    vertex._degree = 0;
+    vertex._removed = true;
+    _ranks.erase(target_rank);
+    _number_of_removed_vertices++;
+    this->clear_landmarks();
+
+    if(_number_of_removed_vertices > _ranks.size()){
+      // Tombstones are the majority, getting rid of them
+      this->compact();
+    }
   }
 };
 
 bool UndirectedGraph::has_vertex(unsigned vertex) const{
-  return _vertices.find(vertex) != _vertices.end();
+  return _ranks.find(vertex) != _ranks.end();
 };
 
 std::list<unsigned> UndirectedGraph::neighbours_for_vertex(unsigned vertex) const{
-  if(! this->has_vertex(vertex)){
+  auto vertex_rank = _ranks.find(vertex);
+  if(vertex_rank == _ranks.end()){
     throw ArgsErrorException("Not a valid vertex id!");
   }
   std::list<unsigned> neighbours;
-  for(auto vertex_pair = _vertices.cbegin();
-      vertex_pair != _vertices.cend();
-      vertex_pair++){
-    if(this->has_edge(vertex, vertex_pair->first)){
-      neighbours.push_back(vertex_pair->first);
-    }
+  const std::vector<Neighbour>& adjacency
+    = _vertices[vertex_rank->second]._neighbours;
+  for(auto neighbour = adjacency.cbegin();
+      neighbour != adjacency.cend();
+      neighbour++){
+    neighbours.push_back(_vertices[neighbour->_rank]._id);
   }
   return neighbours;
 };
@@ -59,37 +114,82 @@ void UndirectedGraph::add_edge(unsigned first_vertex,
   if(first_vertex == second_vertex){
     return;
   }
-  auto first_vertex_pair = _vertices.find(first_vertex);
-  auto second_vertex_pair = _vertices.find(second_vertex);
-  if((first_vertex_pair != _vertices.end())
-     and (second_vertex_pair != _vertices.end())){
-    // Only if given ids are valid vertices ids
-    _edges.emplace(first_vertex, second_vertex, weight);
-    // Updating vertices degrees
-    first_vertex_pair->second._degree++;
-    second_vertex_pair->second._degree++;
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if((first_vertex_rank != _ranks.end())
+     and (second_vertex_rank != _ranks.end())){
+    // Only if given ids are valid vertices ids, and if the edge is
+    // not already in the graph
+    unsigned first_rank = first_vertex_rank->second;
+    unsigned second_rank = second_vertex_rank->second;
+    Vertex& first = _vertices[first_rank];
+    Vertex& second = _vertices[second_rank];
+    if(first._degree > second._degree){
+      if(this->neighbour_position(second_rank, first_rank)
+         != second._neighbours.size()){
+        return;
+      }
+    }
+    else if(this->neighbour_position(first_rank, second_rank)
+            != first._neighbours.size()){
+      return;
+    }
+    // Updating vertices adjacency and degrees
+    first._neighbours.emplace_back(second_rank,
+                                   weight,
+                                   second._neighbours.size());
+    second._neighbours.emplace_back(first_rank,
+                                    weight,
+                                    first._neighbours.size() - 1);
+    first._degree++;
+    second._degree++;
+    _number_of_edges++;
+    _max_weight = std::max(_max_weight, weight);
+    this->clear_landmarks();
   }
 };
 
 void UndirectedGraph::remove_edge(unsigned first_vertex,
                                   unsigned second_vertex){
-  // Removing edge
-  Edge target_edge (first_vertex, second_vertex, 0);
-  if(_edges.erase(target_edge)){
-    // Updating degrees if erase is successful (an edge really exists
-    // between the vertices)
-    auto first_vertex_pair = _vertices.find(first_vertex);
-    auto second_vertex_pair = _vertices.find(second_vertex);
-    first_vertex_pair->second._degree--;
-    second_vertex_pair->second._degree--;
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if((first_vertex_rank == _ranks.end())
+     or (second_vertex_rank == _ranks.end())){
+    return;
+  }
+  // Looking for the edge from the vertex with smallest degree
+  unsigned rank = first_vertex_rank->second;
+  unsigned other_rank = second_vertex_rank->second;
+  if(_vertices[rank]._degree > _vertices[other_rank]._degree){
+    std::swap(rank, other_rank);
+  }
+  std::size_t position = this->neighbour_position(rank, other_rank);
+  if(position != _vertices[rank]._neighbours.size()){
+    // Removing edge and updating degrees if an edge really exists
+    // between the vertices
+    this->drop_neighbour(other_rank,
+                         _vertices[rank]._neighbours[position]._twin);
+    this->drop_neighbour(rank, position);
+    _number_of_edges--;
+    this->clear_landmarks();
   }
 };
 
 bool UndirectedGraph::has_edge(unsigned first_vertex,
                                unsigned second_vertex) const{
-  Edge target_edge (first_vertex, second_vertex, 0);
-  auto target = _edges.find(target_edge);
-  return target != _edges.end();
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if((first_vertex_rank == _ranks.end())
+     or (second_vertex_rank == _ranks.end())){
+    return false;
+  }
+  unsigned rank = first_vertex_rank->second;
+  unsigned other_rank = second_vertex_rank->second;
+  if(_vertices[rank]._degree > _vertices[other_rank]._degree){
+    std::swap(rank, other_rank);
+  }
+  return this->neighbour_position(rank, other_rank)
+    != _vertices[rank]._neighbours.size();
 };
 
 bool UndirectedGraph::are_connected(unsigned first_vertex,
@@ -99,18 +199,25 @@ bool UndirectedGraph::are_connected(unsigned first_vertex,
 
 unsigned UndirectedGraph::edge_weight(unsigned first_vertex,
                                       unsigned second_vertex) const{
-  Edge target_edge (first_vertex, second_vertex, 0);
-  auto target = _edges.find(target_edge);
-  if(target == _edges.end()){
-    std::string message = "Not edge between vertices: "
-      + std::to_string(first_vertex)
-      + " and "
-      + std::to_string(second_vertex);
-    throw  ArgsErrorException(message);
-  }
-  else{
-    return target->_weight;
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if((first_vertex_rank != _ranks.end())
+     and (second_vertex_rank != _ranks.end())){
+    unsigned rank = first_vertex_rank->second;
+    unsigned other_rank = second_vertex_rank->second;
+    if(_vertices[rank]._degree > _vertices[other_rank]._degree){
+      std::swap(rank, other_rank);
+    }
+    std::size_t position = this->neighbour_position(rank, other_rank);
+    if(position != _vertices[rank]._neighbours.size()){
+      return _vertices[rank]._neighbours[position]._weight;
+    }
   }
+  std::string message = "Not edge between vertices: "
+    + std::to_string(first_vertex)
+    + " and "
+    + std::to_string(second_vertex);
+  throw  ArgsErrorException(message);
 };  
 
 unsigned  UndirectedGraph::path_weight(std::list<unsigned> path) const{
@@ -133,6 +240,16 @@ unsigned  UndirectedGraph::path_weight(std::list<unsigned> path) const{
   return weight;
 };
 
+void UndirectedGraph::use_shortest_path_engine(ShortestPathEngine engine,
+                                               unsigned delta,
+                                               unsigned number_of_threads){
+  // delta and number_of_threads are only used for delta-stepping, 0
+  // meaning they are picked automatically
+  _engine = engine;
+  _delta = delta;
+  _number_of_threads = number_of_threads;
+};
+
 std::list<unsigned> UndirectedGraph::shortest_path(unsigned first_vertex,
                                                      unsigned second_vertex) const{
 
@@ -142,125 +259,142 @@ std::list<unsigned> UndirectedGraph::shortest_path(unsigned first_vertex,
     return path;
   }
 
-  // Dijkstra algorithm
+  std::list<unsigned> path;
 
-  // Mapping the vertices id to the current shortest distance from
-  // first_vertex
-  std::map<unsigned, unsigned> shortest_distances;
-  shortest_distances.emplace(first_vertex, 0);
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  if(first_vertex_rank == _ranks.end()){
+    throw ArgsErrorException("Not a valid vertex id!");
+  }
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if(second_vertex_rank == _ranks.end()){
+    // Nothing to reach
+    return path;
+  }
+  unsigned first_rank = first_vertex_rank->second;
+  unsigned second_rank = second_vertex_rank->second;
 
   unsigned inf = std::numeric_limits<unsigned>::max();
-  for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
-    // Init to +inf when vertex has not yet been visited
-    shortest_distances.emplace(vertex->first, inf);
-  }
 
-  // Set of vertices whose shortest distance from first_vertex is not
-  // yet known (init with all but first_vertex)
-  std::set<unsigned> vertices_to_visit;
-  
-  for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
-    if(vertex->first != first_vertex){
-      vertices_to_visit.insert(vertex->first);
-    }
+  // Remembering previous vertex on current shortest path
+  std::vector<unsigned> previous_vertex (_vertices.size());
+
+  // Current shortest distance from first_vertex, +inf when vertex
+  // has not yet been reached
+  std::vector<unsigned> shortest_distances;
+
+  if(_engine == ShortestPathEngine::DELTA_STEPPING){
+    shortest_distances = this->delta_stepping_distances(first_rank,
+                                                        second_rank,
+                                                        previous_vertex);
   }
+  else{
+    // A* algorithm, using landmarks distances to get lower bounds of
+    // the remaining distance to second_vertex. Without landmarks,
+    // lower bounds are all 0 and this is the Dijkstra algorithm.
+    shortest_distances.assign(_vertices.size(), inf);
+    shortest_distances[first_rank] = 0;
 
-  // Remembering previous vertex on current shortest path
-  std::map<unsigned, unsigned> previous_vertex;
+    // Vertices whose shortest distance from first_vertex is final
+    std::vector<bool> visited_vertices (_vertices.size(), false);
 
-  // Starting with neighbours of first_vertex
-  std::list<unsigned> current_neighbours;
+    // Vertices to visit, along with their estimated distance to
+    // second_vertex (outdated entries are skipped when popped)
+    typedef std::pair<unsigned, unsigned> estimate;
+    std::priority_queue<estimate,
+                        std::vector<estimate>,
+                        std::greater<estimate>> vertices_to_visit;
+    vertices_to_visit.emplace(this->landmark_bound(first_rank, second_rank),
+                              first_rank);
 
-  current_neighbours = this->neighbours_for_vertex(first_vertex);
+    while(!vertices_to_visit.empty()){
+      // Visiting vertex with minimum estimated distance
+      unsigned current_rank = vertices_to_visit.top().second;
+      vertices_to_visit.pop();
+      if(visited_vertices[current_rank]){
+        continue;
+      }
+      visited_vertices[current_rank] = true;
 
-  for(auto neighbour = current_neighbours.cbegin();
-      neighbour != current_neighbours.cend();
-      ++neighbour){
-    unsigned current_id = *neighbour;
-    // Storing shortest distance
-    shortest_distances.find(current_id)->second = 
-      this->edge_weight(first_vertex, current_id);
-  
-    // Storing previous vertex on shortest path
-    previous_vertex.emplace(current_id, first_vertex);
-  }
-
-  while(! vertices_to_visit.empty()){
-    // Finding vertex to visit with minimum current shortest distance
-    auto vertex = vertices_to_visit.cbegin();
-    unsigned current_vertex = *vertex;
-    unsigned min_distance = shortest_distances.at(current_vertex);
-    ++vertex;
-    for(; vertex != vertices_to_visit.cend(); ++vertex){
-      unsigned current_distance = shortest_distances.at(*vertex);
-      if(current_distance < min_distance){
-        current_vertex = *vertex;
-        min_distance = current_distance;
+      if(current_rank == second_rank){
+        // Wanted vertex is reached
+        break;
       }
-    }
-    
-    if(min_distance == inf
-       or current_vertex == second_vertex){
-      // No accessible vertex remains or wanted vertex is reached
-      break;
-    }
 
-    // Updating shortest known distance to current_vertex neighbours
-    current_neighbours = this->neighbours_for_vertex(current_vertex);
-    for(auto neighbour = current_neighbours.cbegin();
-        neighbour != current_neighbours.cend();
-        ++neighbour){
-      unsigned neighbour_id = *neighbour;
-      if(vertices_to_visit.find(neighbour_id) != vertices_to_visit.end()){
-        // Only if shortest distance is not yet know for neighbour
-        unsigned possible_shortest_distance =
-          shortest_distances.find(current_vertex)->second
-          + this->edge_weight(current_vertex, neighbour_id);
-        if(shortest_distances.find(neighbour_id)->second >
-           possible_shortest_distance){
-          // Found a better distance to neighbours
-          shortest_distances.find(neighbour_id)->second =
-            possible_shortest_distance;
-          auto prev = previous_vertex.find(neighbour_id);
-          if(prev != previous_vertex.end()){
-            // Updating previous
-            prev->second = current_vertex;
-          }
-          else{
-            // Adding previous for this vertex
-            previous_vertex.emplace(neighbour_id, current_vertex);
-          }
+      // Updating shortest known distance to current vertex neighbours
+      unsigned current_distance = shortest_distances[current_rank];
+      const std::vector<Neighbour>& current_neighbours
+        = _vertices[current_rank]._neighbours;
+      for(auto neighbour = current_neighbours.cbegin();
+          neighbour != current_neighbours.cend();
+          ++neighbour){
+        unsigned neighbour_rank = neighbour->_rank;
+        unsigned possible_shortest_distance
+          = current_distance + neighbour->_weight;
+        if(!visited_vertices[neighbour_rank]
+           and (possible_shortest_distance
+                < shortest_distances[neighbour_rank])){
+          // Found a better distance to neighbour
+          shortest_distances[neighbour_rank] = possible_shortest_distance;
+          previous_vertex[neighbour_rank] = current_rank;
+          vertices_to_visit.emplace(possible_shortest_distance
+                                    + this->landmark_bound(neighbour_rank,
+                                                           second_rank),
+                                    neighbour_rank);
         }
       }
     }
-    // Removing current vertex (its shortest distance from first_vertex is
-    // final in shortest_distances)
-    vertices_to_visit.erase(current_vertex);
   }
   
-  // Recomposing path from the end
-  std::list<unsigned> path;
-
-  auto prev = previous_vertex.find(second_vertex);
-  if(prev == previous_vertex.end()){
+  if(shortest_distances[second_rank] == inf){
     // Argument vertices are not connected, return empty path
     return path;
   }
-  
-  unsigned current_vertex = second_vertex;
+
+  // Recomposing path from the end, using caller ids
+  unsigned current_rank = second_rank;
   // Adding the end
-  path.push_front(current_vertex);
+  path.push_front(second_vertex);
   
-  while(current_vertex != first_vertex){
+  while(current_rank != first_rank){
     // Getting previous vertex
-    current_vertex = previous_vertex.find(current_vertex)->second;
+    current_rank = previous_vertex[current_rank];
     // Adding
-    path.push_front(current_vertex);
+    path.push_front(_vertices[current_rank]._id);
   }
   
   return path;
 };
 
+std::map<unsigned, unsigned> UndirectedGraph::shortest_distances(unsigned source) const{
+  // Shortest distances from source to all vertices it is connected to
+  auto source_rank = _ranks.find(source);
+  if(source_rank == _ranks.end()){
+    throw ArgsErrorException("Not a valid vertex id!");
+  }
+
+  std::vector<unsigned> distances;
+  if(_engine == ShortestPathEngine::DELTA_STEPPING){
+    std::vector<unsigned> previous_vertex;
+    distances = this->delta_stepping_distances(source_rank->second,
+                                               _vertices.size(),
+                                               previous_vertex);
+  }
+  else{
+    distances = this->dijkstra_distances(source_rank->second);
+  }
+
+  std::map<unsigned, unsigned> shortest_distances;
+  for(auto vertex = _ranks.cbegin(); vertex != _ranks.cend(); ++vertex){
+    unsigned distance = distances[vertex->second];
+    if(distance != std::numeric_limits<unsigned>::max()){
+      shortest_distances.emplace_hint(shortest_distances.end(),
+                                      vertex->first,
+                                      distance);
+    }
+  }
+  return shortest_distances;
+};
+
 std::list<unsigned> UndirectedGraph::smallest_path(unsigned first_vertex,
                                                    unsigned second_vertex) const{
 
@@ -270,40 +404,55 @@ std::list<unsigned> UndirectedGraph::smallest_path(unsigned first_vertex,
     return path;
   }
 
-  // Applying breadth-first search
+  // Applying breadth-first search on internal ranks
+  std::list<unsigned> path;
+
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  if(first_vertex_rank == _ranks.end()){
+    throw ArgsErrorException("Not a valid vertex id!");
+  }
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if(second_vertex_rank == _ranks.end()){
+    // Nothing to reach
+    return path;
+  }
+  unsigned first_rank = first_vertex_rank->second;
+  unsigned second_rank = second_vertex_rank->second;
 
   // Storing found vertices to avoid cycles
-  std::set<unsigned> found_vertices ({first_vertex});
+  std::vector<bool> found_vertices (_vertices.size(), false);
+  found_vertices[first_rank] = true;
 
   // Remembering "parent" vertex
-  std::map<unsigned, unsigned> parent_vertex;
-
-  // FIFO list of vertices yet to visit
-  std::list<unsigned> vertices_to_visit ({first_vertex});
+  std::vector<unsigned> parent_vertex (_vertices.size());
 
-  // Neighbours of current vertex
-  std::list<unsigned> current_neighbours;
+  // FIFO of vertices yet to visit, "first in" vertex being at
+  // position next_to_visit
+  std::vector<unsigned> vertices_to_visit ({first_rank});
+  vertices_to_visit.reserve(_vertices.size());
+  std::size_t next_to_visit = 0;
 
   bool found_end = false;
   
-  while(!vertices_to_visit.empty()){
+  while(next_to_visit < vertices_to_visit.size()){
     // Visiting "first in" vertex
-    unsigned current_vertex = vertices_to_visit.front();
-    current_neighbours = this->neighbours_for_vertex(current_vertex);
+    unsigned current_rank = vertices_to_visit[next_to_visit++];
+    const std::vector<Neighbour>& current_neighbours
+      = _vertices[current_rank]._neighbours;
 
     // Adding neighbours for further visiting
     for(auto neighbour = current_neighbours.cbegin();
         neighbour != current_neighbours.cend();
         neighbour++){
-      unsigned neighbour_id = *neighbour;
-      if(found_vertices.find(neighbour_id) == found_vertices.end()){
+      unsigned neighbour_rank = neighbour->_rank;
+      if(!found_vertices[neighbour_rank]){
         // Vertex not yet found
-        found_vertices.insert(neighbour_id);
-        vertices_to_visit.push_back(neighbour_id);
+        found_vertices[neighbour_rank] = true;
+        vertices_to_visit.push_back(neighbour_rank);
         // Storing parent vertex
-        parent_vertex.emplace(neighbour_id, current_vertex);
+        parent_vertex[neighbour_rank] = current_rank;
 
-        if(neighbour_id == second_vertex){
+        if(neighbour_rank == second_rank){
           // Found a path to second_vertex with smallest number of edges
           found_end = true;
         }
@@ -312,43 +461,219 @@ std::list<unsigned> UndirectedGraph::smallest_path(unsigned first_vertex,
     if(found_end){
       break;
     }
-
-    // Removing "first in" vertex
-    vertices_to_visit.pop_front();
   }
 
-  // Recomposing path from the end
-  std::list<unsigned> path;
-
   if(!found_end){
     // Argument vertices are not connected, return empty path
     return path;
   }
   
-  unsigned current_vertex = second_vertex;
+  // Recomposing path from the end, using caller ids
+  unsigned current_rank = second_rank;
   // Adding the end
-  path.push_front(current_vertex);
+  path.push_front(second_vertex);
   
-  while(current_vertex != first_vertex){
+  while(current_rank != first_rank){
     // Getting parent vertex
-    current_vertex = parent_vertex.find(current_vertex)->second;
+    current_rank = parent_vertex[current_rank];
     // Adding
-    path.push_front(current_vertex);
+    path.push_front(_vertices[current_rank]._id);
   }
   
   return path;
 };
 
+std::string UndirectedGraph::ValidationReport::describe() const{
+  std::ostringstream message;
+  if(this->is_valid()){
+    message << "Valid input, bridge: "
+            << _bridge.first << " <-> " << _bridge.second;
+    return message.str();
+  }
+
+  std::string separator = "";
+  if(!_connected){
+    message << "Graph is not connected";
+    separator = "; ";
+  }
+  if(_number_of_bridges != 1){
+    message << separator
+            << "Found " << _number_of_bridges << " bridges instead of one";
+    separator = "; ";
+  }
+  else if(_connected and !_opposite_sides){
+    message << separator
+            << "Vertices are on the same side of the bridge "
+            << _bridge.first << " <-> " << _bridge.second;
+    separator = "; ";
+  }
+  if(!_low_degree_vertices.empty()){
+    message << separator
+            << "Vertices with less than 3 neighbours in their sub-graph ("
+            << _low_degree_vertices.size()
+            << "):";
+    // Only listing a few of them
+    unsigned listed = 0;
+    for(auto vertex = _low_degree_vertices.cbegin();
+        (vertex != _low_degree_vertices.cend()) and (listed < 10);
+        ++vertex, ++listed){
+      message << " " << *vertex;
+    }
+    if(_low_degree_vertices.size() > listed){
+      message << " ...";
+    }
+  }
+  return message.str();
+};
+
+void UndirectedGraph::check_bridges(unsigned first_rank,
+                                    unsigned second_rank,
+                                    ValidationReport& report) const{
+  // Iterative Tarjan bridge search: an edge from parent p to child c
+  // in the depth-first search tree is a bridge if no vertex in the
+  // subtree of c has an edge to an ancestor of c
+  std::vector<unsigned> discovery (_vertices.size(), 0);
+  std::vector<unsigned> low (_vertices.size(), 0);
+  std::vector<unsigned> subtree_end (_vertices.size(), 0);
+  std::vector<unsigned> parent (_vertices.size());
+  unsigned time = 0;
+  std::pair<unsigned, unsigned> bridge_ranks (0, 0);
+
+  // Vertices to explore, along with position of next neighbour to
+  // consider
+  std::vector<std::pair<unsigned, std::size_t>> vertices_to_explore;
+
+  auto explore = [&](unsigned root){
+    discovery[root] = low[root] = ++time;
+    parent[root] = root;
+    vertices_to_explore.emplace_back(root, 0);
+    while(!vertices_to_explore.empty()){
+      unsigned rank = vertices_to_explore.back().first;
+      const std::vector<Neighbour>& neighbours = _vertices[rank]._neighbours;
+      if(vertices_to_explore.back().second < neighbours.size()){
+        unsigned neighbour
+          = neighbours[vertices_to_explore.back().second++]._rank;
+        if(discovery[neighbour] == 0){
+          parent[neighbour] = rank;
+          discovery[neighbour] = low[neighbour] = ++time;
+          vertices_to_explore.emplace_back(neighbour, 0);
+        }
+        else if(neighbour != parent[rank]){
+          low[rank] = std::min(low[rank], discovery[neighbour]);
+        }
+      }
+      else{
+        // Subtree of rank is fully explored
+        subtree_end[rank] = time;
+        vertices_to_explore.pop_back();
+        if(!vertices_to_explore.empty()){
+          unsigned parent_rank = vertices_to_explore.back().first;
+          low[parent_rank] = std::min(low[parent_rank], low[rank]);
+          if(low[rank] > discovery[parent_rank]){
+            report._number_of_bridges++;
+            bridge_ranks = {parent_rank, rank};
+          }
+        }
+      }
+    }
+  };
+
+  explore(first_rank);
+  report._connected = (time == _ranks.size());
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    // Bridges in other components
+    if((discovery[rank] == 0) and !_vertices[rank]._removed){
+      explore(rank);
+    }
+  }
+
+  if(report._number_of_bridges == 1){
+    report._bridge = {_vertices[bridge_ranks.first]._id,
+                      _vertices[bridge_ranks.second]._id};
+    // Vertices on the child side of the bridge are the ones
+    // discovered while exploring its subtree
+    unsigned child = bridge_ranks.second;
+    auto child_side = [&](unsigned rank){
+      return (discovery[child] <= discovery[rank])
+        and (discovery[rank] <= subtree_end[child]);
+    };
+    report._opposite_sides = report._connected
+      and (child_side(first_rank) != child_side(second_rank));
+  }
+};
+
+UndirectedGraph::ValidationReport UndirectedGraph::validate(unsigned first_vertex,
+                                                            unsigned second_vertex,
+                                                            unsigned number_of_threads) const{
+  // Checking find_the_bridge preconditions in linear time: the graph
+  // is made of two sub-graphs linked by a single bridge, every vertex
+  // has at least 3 neighbours in its sub-graph and given vertices are
+  // on both sides of the bridge
+  auto first_vertex_rank = _ranks.find(first_vertex);
+  auto second_vertex_rank = _ranks.find(second_vertex);
+  if((first_vertex_rank == _ranks.end())
+     or (second_vertex_rank == _ranks.end())){
+    throw ArgsErrorException("Not a valid vertex id!");
+  }
+  ValidationReport report;
+
+  if(number_of_threads == 0){
+    number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // At most two threads are used: the Tarjan search, which is most of
+  // the work, runs on its own thread while the calling thread scans
+  // stored degrees. With a single thread both run in turn.
+  std::thread bridges_thread;
+  if(number_of_threads == 1){
+    this->check_bridges(first_vertex_rank->second,
+                        second_vertex_rank->second,
+                        report);
+  }
+  else{
+    bridges_thread = std::thread(&UndirectedGraph::check_bridges,
+                                 this,
+                                 first_vertex_rank->second,
+                                 second_vertex_rank->second,
+                                 std::ref(report));
+  }
+
+  // Vertices with degree 3 are kept too as they lack a neighbour in
+  // their sub-graph if they are a bridge end
+  std::vector<unsigned> candidates;
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    if(!_vertices[rank]._removed and (_vertices[rank]._degree <= 3)){
+      candidates.push_back(rank);
+    }
+  }
+  if(bridges_thread.joinable()){
+    bridges_thread.join();
+  }
+
+  for(auto rank = candidates.cbegin(); rank != candidates.cend(); ++rank){
+    const Vertex& vertex = _vertices[*rank];
+    unsigned degree = vertex._degree;
+    if((report._number_of_bridges == 1)
+       and ((vertex._id == report._bridge.first)
+            or (vertex._id == report._bridge.second))){
+      // The bridge does not count
+      degree--;
+    }
+    if(degree < 3){
+      report._low_degree_vertices.push_back(vertex._id);
+    }
+  }
+  report._low_degree_vertices.sort();
+
+  return report;
+};
+
 std::pair<unsigned, unsigned> UndirectedGraph::find_the_bridge(unsigned first_vertex,
                                                                unsigned second_vertex){
   if(first_vertex == second_vertex){
     throw  ArgsErrorException("Vertices should be different");
   }
 
-  // Copy of current objet to further restore its state, should
-  // definitely be improved
-  UndirectedGraph g (*this);
-
   // Step 1: finding a path between first and second vertex
   const std::list<unsigned> path = this->smallest_path(first_vertex, second_vertex);
 
@@ -368,23 +693,47 @@ std::pair<unsigned, unsigned> UndirectedGraph::find_the_bridge(unsigned first_ve
   // Using this iteration to copy path list in a vector for further
   // easy access to members
   std::vector<unsigned> path_vector ({vertex});
+
+  // Remembering removed edges weights to further restore the state of
+  // the current graph, landmarks distances staying valid once it is
+  // restored
+  std::vector<unsigned> path_weights;
+  std::vector<std::vector<unsigned>> landmark_distances;
+  landmark_distances.swap(_landmark_distances);
+  std::vector<unsigned> landmarks;
+  landmarks.swap(_landmarks);
   
   while(++vertex_iter != path.cend()){
     next_vertex = *vertex_iter;
+    path_weights.push_back(this->edge_weight(vertex, next_vertex));
     this->remove_edge(vertex, next_vertex);
     path_vector.push_back(next_vertex);
 
     vertex = next_vertex;
   }
 
+  auto restore_path = [&](){
+    for(std::size_t i = 0; i < path_weights.size(); ++i){
+      this->add_edge(path_vector[i], path_vector[i + 1], path_weights[i]);
+    }
+    _landmark_distances.swap(landmark_distances);
+    _landmarks.swap(landmarks);
+  };
+
   // First and second vertex should now be unconnected if there is
   // only one bridge and if they are not both in the same subgraph.
   if(this->are_connected(first_vertex, second_vertex)){
+    restore_path();
+    // Finding out which precondition is not met
+    ValidationReport report = this->validate(first_vertex, second_vertex);
     std::string message = "More than one bridge, or "
       + std::to_string(first_vertex)
       + " and "
       + std::to_string(second_vertex)
       + " are in the same subgraph!";
+    if(!report.is_valid()){
+      message = report.describe();
+    }
     throw  ArgsErrorException(message);
   }
 
@@ -412,25 +761,803 @@ std::pair<unsigned, unsigned> UndirectedGraph::find_the_bridge(unsigned first_ve
     {path_vector[rank_inf], path_vector[rank_sup]};
 
   // Restore the state of the current graph
-  *this = g;
+  restore_path();
 
   return bridge;
 };
 
+std::vector<unsigned> UndirectedGraph::bfs_ordering() const{
+  // Breadth-first traversal of each connected component, components
+  // being started in current rank order
+  std::vector<unsigned> ordering;
+  ordering.reserve(_ranks.size());
+  std::vector<bool> found_vertices (_vertices.size(), false);
+
+  for(unsigned root = 0; root < _vertices.size(); ++root){
+    if(found_vertices[root] or _vertices[root]._removed){
+      continue;
+    }
+    found_vertices[root] = true;
+    std::size_t next_to_visit = ordering.size();
+    ordering.push_back(root);
+    while(next_to_visit < ordering.size()){
+      const std::vector<Neighbour>& neighbours
+        = _vertices[ordering[next_to_visit++]]._neighbours;
+      for(auto neighbour = neighbours.cbegin();
+          neighbour != neighbours.cend();
+          ++neighbour){
+        if(!found_vertices[neighbour->_rank]){
+          found_vertices[neighbour->_rank] = true;
+          ordering.push_back(neighbour->_rank);
+        }
+      }
+    }
+  }
+  return ordering;
+};
+
+std::vector<unsigned> UndirectedGraph::cuthill_mckee_ordering() const{
+  // Components are started from their vertex of minimum degree, and
+  // neighbours are visited by increasing degree
+  std::vector<unsigned> by_degree;
+  by_degree.reserve(_ranks.size());
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    if(!_vertices[rank]._removed){
+      by_degree.push_back(rank);
+    }
+  }
+  auto lower_degree = [this](unsigned lhs, unsigned rhs){
+    return _vertices[lhs]._degree < _vertices[rhs]._degree;
+  };
+  std::stable_sort(by_degree.begin(), by_degree.end(), lower_degree);
+
+  std::vector<unsigned> ordering;
+  ordering.reserve(_ranks.size());
+  std::vector<bool> found_vertices (_vertices.size(), false);
+  std::vector<unsigned> new_neighbours;
+
+  for(auto root = by_degree.cbegin(); root != by_degree.cend(); ++root){
+    if(found_vertices[*root]){
+      continue;
+    }
+    found_vertices[*root] = true;
+    std::size_t next_to_visit = ordering.size();
+    ordering.push_back(*root);
+    while(next_to_visit < ordering.size()){
+      const std::vector<Neighbour>& neighbours
+        = _vertices[ordering[next_to_visit++]]._neighbours;
+      new_neighbours.clear();
+      for(auto neighbour = neighbours.cbegin();
+          neighbour != neighbours.cend();
+          ++neighbour){
+        if(!found_vertices[neighbour->_rank]){
+          found_vertices[neighbour->_rank] = true;
+          new_neighbours.push_back(neighbour->_rank);
+        }
+      }
+      std::stable_sort(new_neighbours.begin(),
+                       new_neighbours.end(),
+                       lower_degree);
+      ordering.insert(ordering.end(),
+                      new_neighbours.begin(),
+                      new_neighbours.end());
+    }
+  }
+
+  // Reversing Cuthill-McKee ordering usually reduces fill further
+  std::reverse(ordering.begin(), ordering.end());
+  return ordering;
+};
+
+std::vector<unsigned> UndirectedGraph::degree_ordering() const{
+  // Hubs first, ties keeping current rank order
+  std::vector<unsigned> ordering;
+  ordering.reserve(_ranks.size());
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    if(!_vertices[rank]._removed){
+      ordering.push_back(rank);
+    }
+  }
+  std::stable_sort(ordering.begin(),
+                   ordering.end(),
+                   [this](unsigned lhs, unsigned rhs){
+                     return _vertices[lhs]._degree > _vertices[rhs]._degree;
+                   });
+  return ordering;
+};
+
+void UndirectedGraph::rebuild_vertices(const std::vector<unsigned>& old_ranks){
+  // Vertices not in old_ranks are dropped, they should be tombstones
+  unsigned removed = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> new_ranks (_vertices.size(), removed);
+  for(unsigned rank = 0; rank < old_ranks.size(); ++rank){
+    new_ranks[old_ranks[rank]] = rank;
+  }
+
+  // Rebuilding vertices (and their adjacency) in the new order so
+  // that neighbours are allocated close together
+  std::vector<Vertex> vertices;
+  vertices.reserve(old_ranks.size());
+  _max_weight = 0;
+  for(auto old_rank = old_ranks.cbegin();
+      old_rank != old_ranks.cend();
+      ++old_rank){
+    Vertex& old_vertex = _vertices[*old_rank];
+    vertices.emplace_back(old_vertex._id);
+    Vertex& vertex = vertices.back();
+    vertex._degree = old_vertex._degree;
+    vertex._neighbours.reserve(old_vertex._neighbours.size());
+    for(auto neighbour = old_vertex._neighbours.cbegin();
+        neighbour != old_vertex._neighbours.cend();
+        ++neighbour){
+      vertex._neighbours.emplace_back(new_ranks[neighbour->_rank],
+                                      neighbour->_weight,
+                                      0);
+      _max_weight = std::max(_max_weight, neighbour->_weight);
+    }
+    // Scanning neighbours in increasing rank order
+    std::sort(vertex._neighbours.begin(),
+              vertex._neighbours.end(),
+              [](const Neighbour& lhs, const Neighbour& rhs){
+                return lhs._rank < rhs._rank;
+              });
+
+    // Keeping caller ids mapped with their new rank
+    _ranks.find(vertex._id)->second = vertices.size() - 1;
+  }
+
+  // Setting reverse entries positions: vertices being visited in
+  // increasing rank order, the k-th time a vertex is reached matches
+  // its k-th (sorted) adjacency entry
+  std::vector<unsigned> reached (vertices.size(), 0);
+  for(unsigned rank = 0; rank < vertices.size(); ++rank){
+    std::vector<Neighbour>& neighbours = vertices[rank]._neighbours;
+    for(auto neighbour = neighbours.begin();
+        neighbour != neighbours.end();
+        ++neighbour){
+      neighbour->_twin = reached[neighbour->_rank]++;
+    }
+  }
+
+  _vertices.swap(vertices);
+  _number_of_removed_vertices = 0;
+
+  // Following new ranks in landmarks data
+  for(auto landmark = _landmarks.begin();
+      landmark != _landmarks.end();
+      ++landmark){
+    *landmark = new_ranks[*landmark];
+  }
+  for(auto distances = _landmark_distances.begin();
+      distances != _landmark_distances.end();
+      ++distances){
+    std::vector<unsigned> new_distances (old_ranks.size());
+    for(unsigned rank = 0; rank < old_ranks.size(); ++rank){
+      new_distances[rank] = (*distances)[old_ranks[rank]];
+    }
+    distances->swap(new_distances);
+  }
+};
+
+void UndirectedGraph::reorder_vertices(VertexOrdering ordering){
+  // Getting old ranks in their new order, tombstones being dropped
+  std::vector<unsigned> old_ranks;
+  switch(ordering){
+  case VertexOrdering::BFS:
+    old_ranks = this->bfs_ordering();
+    break;
+  case VertexOrdering::REVERSE_CUTHILL_MCKEE:
+    old_ranks = this->cuthill_mckee_ordering();
+    break;
+  case VertexOrdering::DEGREE:
+    old_ranks = this->degree_ordering();
+    break;
+  }
+  this->rebuild_vertices(old_ranks);
+};
+
+void UndirectedGraph::compact(){
+  // Dropping tombstones while keeping current order
+  std::vector<unsigned> old_ranks;
+  old_ranks.reserve(_ranks.size());
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    if(!_vertices[rank]._removed){
+      old_ranks.push_back(rank);
+    }
+  }
+  this->rebuild_vertices(old_ranks);
+};
+
+std::vector<unsigned> UndirectedGraph::dijkstra_distances(unsigned source_rank) const{
+  // Shortest distances from source_rank to all vertices, +inf for
+  // vertices that can't be reached
+  unsigned inf = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> shortest_distances (_vertices.size(), inf);
+  shortest_distances[source_rank] = 0;
+
+  typedef std::pair<unsigned, unsigned> estimate;
+  std::priority_queue<estimate,
+                      std::vector<estimate>,
+                      std::greater<estimate>> vertices_to_visit;
+  vertices_to_visit.emplace(0, source_rank);
+
+  while(!vertices_to_visit.empty()){
+    unsigned current_distance = vertices_to_visit.top().first;
+    unsigned current_rank = vertices_to_visit.top().second;
+    vertices_to_visit.pop();
+    if(current_distance > shortest_distances[current_rank]){
+      // Outdated entry
+      continue;
+    }
+    const std::vector<Neighbour>& current_neighbours
+      = _vertices[current_rank]._neighbours;
+    for(auto neighbour = current_neighbours.cbegin();
+        neighbour != current_neighbours.cend();
+        ++neighbour){
+      unsigned possible_shortest_distance
+        = current_distance + neighbour->_weight;
+      if(possible_shortest_distance < shortest_distances[neighbour->_rank]){
+        shortest_distances[neighbour->_rank] = possible_shortest_distance;
+        vertices_to_visit.emplace(possible_shortest_distance,
+                                  neighbour->_rank);
+      }
+    }
+  }
+  return shortest_distances;
+};
+
+void UndirectedGraph::collect_requests(const std::vector<unsigned>& frontier,
+                                       std::size_t begin,
+                                       std::size_t end,
+                                       const std::vector<unsigned>& distances,
+                                       unsigned delta,
+                                       bool light_edges,
+                                       std::vector<std::vector<Request>>& requests) const{
+  // Relaxation requests for light (weight <= delta) or heavy edges
+  // leaving frontier vertices between begin and end, split by owner of
+  // the relaxed vertex (rank modulo number of owners). Only reads
+  // distances so that several threads may run it on separate parts of
+  // frontier.
+  for(auto owner_requests = requests.begin();
+      owner_requests != requests.end();
+      ++owner_requests){
+    owner_requests->clear();
+  }
+  for(std::size_t i = begin; i < end; ++i){
+    unsigned rank = frontier[i];
+    const std::vector<Neighbour>& neighbours = _vertices[rank]._neighbours;
+    for(auto neighbour = neighbours.cbegin();
+        neighbour != neighbours.cend();
+        ++neighbour){
+      unsigned possible_distance = distances[rank] + neighbour->_weight;
+      if(((neighbour->_weight <= delta) == light_edges)
+         and (possible_distance < distances[neighbour->_rank])){
+        requests[neighbour->_rank % requests.size()]
+          .emplace_back(neighbour->_rank, possible_distance, rank);
+      }
+    }
+  }
+};
+
+std::vector<unsigned> UndirectedGraph::delta_stepping_distances(unsigned source_rank,
+                                                                unsigned target_rank,
+                                                                std::vector<unsigned>& previous_vertex) const{
+  // Shortest distances from source_rank using delta-stepping, +inf
+  // for vertices that can't be reached. The search stops as soon as
+  // the distance to target_rank is final, if it is a valid rank.
+  unsigned inf = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> distances (_vertices.size(), inf);
+  previous_vertex.assign(_vertices.size(), source_rank);
+
+  unsigned delta = _delta;
+  if(delta == 0){
+    // Usual choice: maximum weight divided by average degree
+    unsigned long long total_degree = 2 * (unsigned long long) _number_of_edges;
+    delta = std::max(1ULL,
+                     (unsigned long long) _max_weight * _ranks.size()
+                     / std::max(1ULL, total_degree));
+  }
+
+  unsigned number_of_threads = _number_of_threads;
+  if(number_of_threads == 0){
+    number_of_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Buckets are kept in a window of consecutive bucket numbers,
+  // starting at window_begin and indexed modulo its size. Pending
+  // buckets are at most max_weight / delta + 1 after current one so
+  // they all fit in the window, unless it has been capped (small delta
+  // with large weights): further vertices then wait in overflow until
+  // the window is exhausted. Buckets may hold outdated entries,
+  // skipped when a vertex distance does not match the bucket anymore.
+  unsigned long long window_size
+    = std::min((unsigned long long) _max_weight / delta + 2,
+               (unsigned long long) _vertices.size() + 1);
+  std::vector<std::vector<unsigned>> window (window_size);
+  std::size_t window_entries = 0;
+  unsigned long long window_begin = 0;
+  std::vector<unsigned> overflow;
+  auto add_to_bucket = [&](unsigned rank){
+    unsigned long long bucket = distances[rank] / delta;
+    if(bucket < window_begin + window_size){
+      window[bucket % window_size].push_back(rank);
+      ++window_entries;
+    }
+    else{
+      overflow.push_back(rank);
+    }
+  };
+
+  // requests[thread][owner] holds requests collected by thread for
+  // vertices owned by owner, which is the only thread writing their
+  // distance. Improved vertices are staged per owner, then added to
+  // buckets by the calling thread.
+  std::vector<std::vector<std::vector<Request>>> requests
+    (number_of_threads, std::vector<std::vector<Request>>(number_of_threads));
+  std::vector<std::vector<unsigned>> staged (number_of_threads);
+  const std::vector<unsigned>* phase_frontier = nullptr;
+  bool phase_light_edges = true;
+  bool phase_apply = false;
+
+  auto part = [&](unsigned thread){
+    if(!phase_apply){
+      std::size_t size = phase_frontier->size();
+      this->collect_requests(*phase_frontier,
+                             thread * size / number_of_threads,
+                             (thread + 1) * size / number_of_threads,
+                             distances,
+                             delta,
+                             phase_light_edges,
+                             requests[thread]);
+      return;
+    }
+    staged[thread].clear();
+    for(auto thread_requests = requests.begin();
+        thread_requests != requests.end();
+        ++thread_requests){
+      std::vector<Request>& owned = (*thread_requests)[thread];
+      for(auto request = owned.cbegin(); request != owned.cend(); ++request){
+        if(request->_distance < distances[request->_rank]){
+          distances[request->_rank] = request->_distance;
+          previous_vertex[request->_rank] = request->_previous;
+          staged[thread].push_back(request->_rank);
+        }
+      }
+      // Requests have to be read only once
+      owned.clear();
+    }
+  };
+
+  // Worker threads are started once for the whole run and wait for
+  // each step, the calling thread handling part 0. Distances are only
+  // read while collecting requests and each one is only written by
+  // its owner while applying them.
+  std::mutex phase_mutex;
+  std::condition_variable phase_start;
+  std::condition_variable phase_end;
+  unsigned phase_number = 0;
+  unsigned busy_workers = 0;
+  bool stop_workers = false;
+
+  auto worker = [&](unsigned thread){
+    unsigned last_phase = 0;
+    while(true){
+      std::unique_lock<std::mutex> lock (phase_mutex);
+      phase_start.wait(lock, [&](){
+          return stop_workers or (phase_number != last_phase);
+        });
+      if(stop_workers){
+        return;
+      }
+      last_phase = phase_number;
+      lock.unlock();
+
+      part(thread);
+
+      lock.lock();
+      if(--busy_workers == 0){
+        phase_end.notify_one();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  auto stop = [&](){
+    {
+      std::lock_guard<std::mutex> lock (phase_mutex);
+      stop_workers = true;
+    }
+    phase_start.notify_all();
+    for(auto thread = workers.begin(); thread != workers.end(); ++thread){
+      thread->join();
+    }
+    workers.clear();
+  };
+
+  auto run_parts = [&](bool parallel){
+    if(!parallel){
+      for(unsigned thread = 0; thread < number_of_threads; ++thread){
+        part(thread);
+      }
+      return;
+    }
+    if(workers.empty()){
+      for(unsigned thread = 1; thread < number_of_threads; ++thread){
+        workers.emplace_back(worker, thread);
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock (phase_mutex);
+      busy_workers = number_of_threads - 1;
+      ++phase_number;
+    }
+    phase_start.notify_all();
+    part(0);
+    std::unique_lock<std::mutex> lock (phase_mutex);
+    phase_end.wait(lock, [&](){ return busy_workers == 0; });
+  };
+
+  auto relax = [&](const std::vector<unsigned>& frontier, bool light_edges){
+    // Not worth waking workers up for small frontiers
+    bool parallel = (number_of_threads > 1) and (frontier.size() >= 1024);
+    phase_frontier = &frontier;
+    phase_light_edges = light_edges;
+    phase_apply = false;
+    run_parts(parallel);
+    phase_apply = true;
+    run_parts(parallel);
+    for(auto owner_staged = staged.cbegin();
+        owner_staged != staged.cend();
+        ++owner_staged){
+      for(auto rank = owner_staged->cbegin();
+          rank != owner_staged->cend();
+          ++rank){
+        add_to_bucket(*rank);
+      }
+    }
+  };
+
+  // Vertices handled in current phase, and in current bucket. Bucket
+  // numbers are stored shifted by one in settled_bucket as 0 marks
+  // vertices not yet settled.
+  std::vector<unsigned> frontier;
+  std::vector<unsigned> settled;
+  std::vector<unsigned> frontier_phase (_vertices.size(), 0);
+  std::vector<unsigned long long> settled_bucket (_vertices.size(), 0);
+  unsigned phase = 0;
+
+  distances[source_rank] = 0;
+  add_to_bucket(source_rank);
+  unsigned long long bucket = 0;
+
+  try{
+    while(true){
+      if((window_entries == 0) or (bucket == window_begin + window_size)){
+        // Window exhausted, moving it to the first overflow bucket
+        // still holding a vertex that is not settled
+        std::vector<unsigned> pending;
+        pending.swap(overflow);
+        window_begin = std::numeric_limits<unsigned long long>::max();
+        for(auto rank = pending.cbegin(); rank != pending.cend(); ++rank){
+          if(settled_bucket[*rank] == 0){
+            window_begin = std::min(window_begin,
+                                    (unsigned long long) distances[*rank] / delta);
+          }
+        }
+        if(window_begin == std::numeric_limits<unsigned long long>::max()){
+          break;
+        }
+        for(auto rank = pending.cbegin(); rank != pending.cend(); ++rank){
+          if(settled_bucket[*rank] == 0){
+            add_to_bucket(*rank);
+          }
+        }
+        bucket = window_begin;
+      }
+
+      std::vector<unsigned>& current_bucket = window[bucket % window_size];
+      if(current_bucket.empty()){
+        ++bucket;
+        continue;
+      }
+      if((target_rank < _vertices.size())
+         and (distances[target_rank] < bucket * delta)){
+        // All distances below current bucket lower bound are final
+        break;
+      }
+      settled.clear();
+
+      while(!current_bucket.empty()){
+        // Phase: relaxing light edges from vertices in current bucket,
+        // which may bring vertices back into it
+        ++phase;
+        frontier.clear();
+        for(auto rank = current_bucket.cbegin();
+            rank != current_bucket.cend();
+            ++rank){
+          if((distances[*rank] / delta == bucket)
+             and (frontier_phase[*rank] != phase)){
+            frontier_phase[*rank] = phase;
+            frontier.push_back(*rank);
+            if(settled_bucket[*rank] != bucket + 1){
+              settled_bucket[*rank] = bucket + 1;
+              settled.push_back(*rank);
+            }
+          }
+        }
+        window_entries -= current_bucket.size();
+        current_bucket.clear();
+
+        relax(frontier, true);
+      }
+
+      // Distances are final for current bucket, relaxing heavy edges
+      relax(settled, false);
+      ++bucket;
+    }
+  }
+  catch(...){
+    stop();
+    throw;
+  }
+  stop();
+
+  return distances;
+};
+
+unsigned UndirectedGraph::landmark_bound(unsigned rank,
+                                         unsigned target_rank) const{
+  // Using triangle inequality: for any landmark l, d(rank, target)
+  // >= |d(l, target) - d(l, rank)|
+  unsigned inf = std::numeric_limits<unsigned>::max();
+  unsigned bound = 0;
+  for(auto distances = _landmark_distances.cbegin();
+      distances != _landmark_distances.cend();
+      ++distances){
+    unsigned from_landmark = (*distances)[rank];
+    unsigned to_target = (*distances)[target_rank];
+    if((from_landmark != inf) and (to_target != inf)){
+      bound = std::max(bound,
+                       std::max(from_landmark, to_target)
+                       - std::min(from_landmark, to_target));
+    }
+  }
+  return bound;
+};
+
+void UndirectedGraph::clear_landmarks(){
+  // Distances are no longer reliable
+  _landmarks.clear();
+  _landmark_distances.clear();
+};
+
+void UndirectedGraph::compute_landmarks(unsigned number_of_landmarks){
+  this->clear_landmarks();
+  number_of_landmarks = std::min(number_of_landmarks,
+                                 (unsigned) _ranks.size());
+
+  // Farthest point selection: each new landmark maximizes its
+  // distance to previous landmarks, vertices not reachable from any
+  // landmark (other components) coming first
+  unsigned inf = std::numeric_limits<unsigned>::max();
+  std::vector<unsigned> distance_to_landmarks (_vertices.size(), inf);
+  unsigned next_landmark = _vertices.size();
+  for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+    if(!_vertices[rank]._removed){
+      // Farthest vertex from an arbitrary one is a better start
+      std::vector<unsigned> distances = this->dijkstra_distances(rank);
+      next_landmark = rank;
+      for(unsigned other = 0; other < distances.size(); ++other){
+        if((distances[other] != inf)
+           and (distances[other] > distances[next_landmark])){
+          next_landmark = other;
+        }
+      }
+      break;
+    }
+  }
+
+  while(_landmarks.size() < number_of_landmarks){
+    _landmarks.push_back(next_landmark);
+    _landmark_distances.push_back(this->dijkstra_distances(next_landmark));
+    const std::vector<unsigned>& distances = _landmark_distances.back();
+
+    bool found_next = false;
+    for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+      if(_vertices[rank]._removed){
+        continue;
+      }
+      distance_to_landmarks[rank] = std::min(distance_to_landmarks[rank],
+                                             distances[rank]);
+      if(distance_to_landmarks[rank] > 0
+         and (!found_next
+              or (distance_to_landmarks[rank]
+                  > distance_to_landmarks[next_landmark]))){
+        next_landmark = rank;
+        found_next = true;
+      }
+    }
+    if(!found_next){
+      // All vertices are landmarks
+      break;
+    }
+  }
+};
+
+unsigned UndirectedGraph::number_of_landmarks() const{
+  return _landmarks.size();
+};
+
+void UndirectedGraph::visit_by_id(const std::function<void(unsigned, unsigned)>& visit_vertex,
+                                  const std::function<void(const Edge&)>& visit_edge) const{
+  std::vector<Edge> edges;
+  for(auto vertex = _ranks.cbegin(); vertex != _ranks.cend(); ++vertex){
+    const Vertex& current = _vertices[vertex->second];
+    visit_vertex(vertex->first, current._degree);
+
+    // Each edge is visited from its vertex with smallest id, vertices
+    // being visited by id only these edges have to be sorted
+    edges.clear();
+    for(auto neighbour = current._neighbours.cbegin();
+        neighbour != current._neighbours.cend();
+        ++neighbour){
+      unsigned neighbour_id = _vertices[neighbour->_rank]._id;
+      if(vertex->first < neighbour_id){
+        edges.emplace_back(vertex->first, neighbour_id, neighbour->_weight);
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    for(auto edge = edges.cbegin(); edge != edges.cend(); ++edge){
+      visit_edge(*edge);
+    }
+  }
+};
+
+uint64_t UndirectedGraph::edges_fingerprint() const{
+  // FNV-1a hash of (smallest id, largest id, weight) for all edges, in
+  // id order so that it does not depend on ranks
+  uint64_t fingerprint = 14695981039346656037ULL;
+  auto hash = [&fingerprint](uint32_t value){
+    for(unsigned byte = 0; byte < 4; ++byte){
+      fingerprint ^= (value >> (8 * byte)) & 0xff;
+      fingerprint *= 1099511628211ULL;
+    }
+  };
+
+  this->visit_by_id([](unsigned, unsigned){},
+                    [&hash](const Edge& edge){
+                      hash(edge._first_vertex);
+                      hash(edge._second_vertex);
+                      hash(edge._weight);
+                    });
+  return fingerprint;
+};
+
+void UndirectedGraph::save_landmarks(const std::string& file_path) const{
+  // Binary format: "FTBL" tag, number of landmarks, number of vertices
+  // and number of edges, 64 bits fingerprint of the edges, vertices
+  // ids in rank order, landmarks ids, then distances from each
+  // landmark in rank order. Other values are stored as 32 bits
+  // unsigned.
+  std::ofstream out (file_path, std::ios::binary);
+  if(!out){
+    throw ArgsErrorException("Unable to write file: " + file_path);
+  }
+
+  std::vector<uint32_t> header ({static_cast<uint32_t>(_landmarks.size()),
+                                 static_cast<uint32_t>(_ranks.size()),
+                                 _number_of_edges});
+  uint64_t fingerprint = this->edges_fingerprint();
+  out.write("FTBL", 4);
+  out.write(reinterpret_cast<const char*>(header.data()),
+            header.size() * sizeof(uint32_t));
+  out.write(reinterpret_cast<const char*>(&fingerprint), sizeof(uint64_t));
+
+  std::vector<uint32_t> values;
+  values.reserve(_ranks.size());
+  for(auto vertex = _vertices.cbegin(); vertex != _vertices.cend(); ++vertex){
+    if(!vertex->_removed){
+      values.push_back(vertex->_id);
+    }
+  }
+  for(auto landmark = _landmarks.cbegin();
+      landmark != _landmarks.cend();
+      ++landmark){
+    values.push_back(_vertices[*landmark]._id);
+  }
+  out.write(reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(uint32_t));
+
+  for(auto distances = _landmark_distances.cbegin();
+      distances != _landmark_distances.cend();
+      ++distances){
+    values.clear();
+    for(unsigned rank = 0; rank < _vertices.size(); ++rank){
+      if(!_vertices[rank]._removed){
+        values.push_back((*distances)[rank]);
+      }
+    }
+    out.write(reinterpret_cast<const char*>(values.data()),
+              values.size() * sizeof(uint32_t));
+  }
+
+  if(!out){
+    throw ArgsErrorException("Unable to write file: " + file_path);
+  }
+};
+
+void UndirectedGraph::load_landmarks(const std::string& file_path){
+  // Reading a file written by save_landmarks for this very graph,
+  // possibly with different ranks
+  std::ifstream in (file_path, std::ios::binary);
+  if(!in){
+    throw ArgsErrorException("Unable to read file: " + file_path);
+  }
+  std::string mismatch = "Landmarks file does not match the graph: "
+    + file_path;
+
+  char tag[4];
+  std::vector<uint32_t> header (3);
+  in.read(tag, 4);
+  in.read(reinterpret_cast<char*>(header.data()),
+          header.size() * sizeof(uint32_t));
+  uint64_t fingerprint;
+  in.read(reinterpret_cast<char*>(&fingerprint), sizeof(uint64_t));
+  if(!in or (std::string(tag, 4) != "FTBL")){
+    throw ArgsErrorException("Not a landmarks file: " + file_path);
+  }
+  // Distances are only valid lower bounds for the exact same edges
+  // and weights, landmarks being distinct vertices
+  if((header[1] != _ranks.size())
+     or (header[0] > header[1])
+     or (header[2] != _number_of_edges)
+     or (fingerprint != this->edges_fingerprint())){
+    throw ArgsErrorException(mismatch);
+  }
+
+  std::vector<uint32_t> ids (static_cast<std::size_t>(header[1]) + header[0]);
+  in.read(reinterpret_cast<char*>(ids.data()),
+          ids.size() * sizeof(uint32_t));
+  if(!in){
+    throw ArgsErrorException(mismatch);
+  }
+  // Ranks for the ids stored in the file
+  std::vector<unsigned> ranks;
+  ranks.reserve(ids.size());
+  for(auto id = ids.cbegin(); id != ids.cend(); ++id){
+    auto rank = _ranks.find(*id);
+    if(rank == _ranks.end()){
+      throw ArgsErrorException(mismatch);
+    }
+    ranks.push_back(rank->second);
+  }
+
+  std::vector<unsigned> landmarks (ranks.begin() + header[1], ranks.end());
+  std::vector<std::vector<unsigned>> landmark_distances;
+  std::vector<uint32_t> values (header[1]);
+  for(unsigned i = 0; i < header[0]; ++i){
+    in.read(reinterpret_cast<char*>(values.data()),
+            values.size() * sizeof(uint32_t));
+    if(!in){
+      throw ArgsErrorException(mismatch);
+    }
+    landmark_distances.emplace_back(_vertices.size(),
+                                    std::numeric_limits<unsigned>::max());
+    std::vector<unsigned>& distances = landmark_distances.back();
+    for(unsigned j = 0; j < header[1]; ++j){
+      distances[ranks[j]] = values[j];
+    }
+  }
+  // Nothing may follow the last landmark distances
+  if(in.peek() != std::ifstream::traits_type::eof()){
+    throw ArgsErrorException(mismatch);
+  }
+
+  _landmarks.swap(landmarks);
+  _landmark_distances.swap(landmark_distances);
+};
+
 void UndirectedGraph::log() const{
-  std::cout << "****************** Graph log ******************\n"
-    << "* Vertices:\n";
-  for(auto vertex = _vertices.begin(); vertex != _vertices.end(); vertex++){
-    std::cout << "** Id: "
-              << vertex->first
-              << std::endl
-              << "*** ";
-    vertex->second.log();
-    std::cout << std::endl;
-  }
-  std::cout << "* Edges:\n";
-  for(auto edge = _edges.begin(); edge != _edges.end(); edge++){
-    edge->log();
-  }
-  std::cout << std::endl;
+  GraphExporter exporter (GraphExporter::Format::LOG);
+  exporter.write(*this);
 };
@@ -2,29 +2,31 @@
 #define UNDIRECTEDGRAPH_H
 
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <fstream>
 #include <algorithm>
+#include <functional>
 #include <set>
 #include <list>
+#include <vector>
 #include <map>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <limits>
+#include <cstdint>
 #include "exceptions.h"
 
 class UndirectedGraph{
-private:
-  // Vertex description
-  class Vertex{
-  public:
-    unsigned _degree;                // vertex degree in the graph
+public:
+  // Vertex orderings available for reorder_vertices
+  enum class VertexOrdering {BFS, REVERSE_CUTHILL_MCKEE, DEGREE};
 
-    Vertex():
-      _degree(0){}
+  // Algorithms available for weighted shortest paths
+  enum class ShortestPathEngine {DIJKSTRA, DELTA_STEPPING};
 
-    // Print vertex information
-    void log() const{
-      std::cout << "Degree: " << _degree;
-    };
-  };
-  
   // Edge description
   class Edge{
   public:
@@ -39,25 +41,154 @@ private:
       _second_vertex(std::max(first_vertex, second_vertex)),
       _weight(weight) {}
     
-    // Operator used in a set<Edge>
+    // Operator used to sort edges
     bool operator<(const Edge& rhs) const{
       return (this->_first_vertex < rhs._first_vertex)
         or ((this->_first_vertex == rhs._first_vertex)
             and (this->_second_vertex < rhs._second_vertex));
     };
+  };
+
+  // Result of checking find_the_bridge preconditions
+  class ValidationReport{
+  public:
+    bool _connected;                 // whole graph is connected
+    unsigned _number_of_bridges;     // in the whole graph
+    std::pair<unsigned, unsigned> _bridge; // only relevant if there is
+                                           // exactly one bridge
+    bool _opposite_sides;            // given vertices are on both sides
+                                     // of the bridge
+    std::list<unsigned> _low_degree_vertices; // vertices with less than
+                                              // 3 neighbours in their
+                                              // sub-graph
 
-    // Print edge information
-    void log() const{
-      std::cout << _first_vertex << "<--" << _weight << "-->"
-                << _second_vertex
-                << " ; ";
+    ValidationReport():
+      _connected(false),
+      _number_of_bridges(0),
+      _bridge(0, 0),
+      _opposite_sides(false) {}
+
+    bool is_valid() const{
+      return _connected
+        and (_number_of_bridges == 1)
+        and _opposite_sides
+        and _low_degree_vertices.empty();
     };
+
+    // Human readable description of failed conditions
+    std::string describe() const;
   };
 
-  std::map<unsigned, Vertex> _vertices; // graph vertices mapped with
-                                        // their ids in the graph
+private:
+  // Adjacency entry description
+  class Neighbour{
+  public:
+    unsigned _rank;                  // internal rank of adjacent vertex
+    unsigned _weight;                // weight of the edge
+    unsigned _twin;                  // position of the reverse entry in
+                                     // adjacent vertex neighbours
+
+    Neighbour(unsigned rank,
+              unsigned weight,
+              unsigned twin):
+      _rank(rank),
+      _weight(weight),
+      _twin(twin) {}
+  };
+
+  // Relaxation request description, used in delta-stepping
+  class Request{
+  public:
+    unsigned _rank;                  // rank of vertex to relax
+    unsigned _distance;              // candidate distance from source
+    unsigned _previous;              // rank of previous vertex on path
+
+    Request(unsigned rank,
+            unsigned distance,
+            unsigned previous):
+      _rank(rank),
+      _distance(distance),
+      _previous(previous) {}
+  };
+
+  // Vertex description
+  class Vertex{
+  public:
+    unsigned _id;                    // vertex id as given by the caller
+    unsigned _degree;                // vertex degree in the graph
+    bool _removed;                   // tombstone, until next compaction
+    std::vector<Neighbour> _neighbours; // adjacent vertices, in no
+                                        // particular order
+
+    Vertex(unsigned id):
+      _id(id),
+      _degree(0),
+      _removed(false){}
+  };
+
+  std::vector<Vertex> _vertices;        // graph vertices, indexed by
+                                        // their internal rank
+
+  std::map<unsigned, unsigned> _ranks;  // caller vertex ids mapped
+                                        // with internal ranks
 
-  std::set<Edge> _edges;                // set of graph edges
+  unsigned _number_of_edges;
+
+  unsigned _number_of_removed_vertices; // tombstones in _vertices
+
+  unsigned _max_weight;                 // upper bound of edges weights,
+                                        // exact after rebuild_vertices
+
+  std::vector<unsigned> _landmarks;     // ranks of landmark vertices
+
+  std::vector<std::vector<unsigned>> _landmark_distances;
+                                        // distances from each
+                                        // landmark, indexed by rank
+
+  ShortestPathEngine _engine;           // used for weighted shortest
+                                        // paths
+
+  unsigned _delta;                      // delta-stepping bucket width,
+                                        // 0 to derive it from weights
+
+  unsigned _number_of_threads;          // used for delta-stepping
+
+  std::size_t neighbour_position(unsigned rank,
+                                 unsigned neighbour_rank) const;
+
+  void drop_neighbour(unsigned rank, std::size_t position);
+
+  void rebuild_vertices(const std::vector<unsigned>& old_ranks);
+
+  std::vector<unsigned> dijkstra_distances(unsigned source_rank) const;
+
+  void collect_requests(const std::vector<unsigned>& frontier,
+                        std::size_t begin,
+                        std::size_t end,
+                        const std::vector<unsigned>& distances,
+                        unsigned delta,
+                        bool light_edges,
+                        std::vector<std::vector<Request>>& requests) const;
+
+  std::vector<unsigned> delta_stepping_distances(unsigned source_rank,
+                                                 unsigned target_rank,
+                                                 std::vector<unsigned>& previous_vertex) const;
+
+  unsigned landmark_bound(unsigned rank, unsigned target_rank) const;
+
+  void clear_landmarks();
+
+  uint64_t edges_fingerprint() const;
+
+  void check_bridges(unsigned first_rank,
+                     unsigned second_rank,
+                     ValidationReport& report) const;
+
+  std::vector<unsigned> bfs_ordering() const;
+
+  std::vector<unsigned> cuthill_mckee_ordering() const;
+
+  std::vector<unsigned> degree_ordering() const;
 
 public:
 
@@ -92,14 +223,42 @@ public:
 
   unsigned path_weight(std::list<unsigned> path) const;
 
+  void use_shortest_path_engine(ShortestPathEngine engine,
+                                unsigned delta = 0,
+                                unsigned number_of_threads = 0);
+
   std::list<unsigned> shortest_path(unsigned first_vertex,
                                     unsigned second_vertex) const;
 
+  std::map<unsigned, unsigned> shortest_distances(unsigned source) const;
+
   std::list<unsigned> smallest_path(unsigned first_vertex,
                                     unsigned second_vertex) const;
 
+  ValidationReport validate(unsigned first_vertex,
+                            unsigned second_vertex,
+                            unsigned number_of_threads = 0) const;
+
   std::pair<unsigned, unsigned> find_the_bridge(unsigned first_vertex,
                                                 unsigned second_vertex);
+
+  void reorder_vertices(VertexOrdering ordering);
+
+  void compact();
+
+  void compute_landmarks(unsigned number_of_landmarks);
+
+  unsigned number_of_landmarks() const;
+
+  void save_landmarks(const std::string& file_path) const;
+
+  void load_landmarks(const std::string& file_path);
+
+  // Visits vertices by increasing id, along with their degree, each
+  // vertex being followed by the edges to its neighbours with larger
+  // id, sorted by neighbour id
+  void visit_by_id(const std::function<void(unsigned, unsigned)>& visit_vertex,
+                   const std::function<void(const Edge&)>& visit_edge) const;
   
   void log() const;
 };